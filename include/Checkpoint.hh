@@ -0,0 +1,52 @@
+#pragma once
+#include "globals.hh"
+#include <cstdint>
+#include <string>
+
+
+// Periodic checkpointing for long runs. A checkpoint is taken at the end of an
+// event and records everything needed to continue bit-identically: the RNG
+// engine state, the run/event position and the byte offsets of the output CSVs.
+struct CheckpointConfig {
+  G4long   everyEvents  = 0;            // checkpoint every K events (0 = off)
+  G4double everyMinutes = 0.0;          // ... or every T minutes of wall time (0 = off)
+  std::string path      = "lekid.ckpt"; // metadata file; RNG state sits next to it
+  G4bool   resume       = false;        // continue from 'path' (cleared once reached)
+  std::string macro;                    // macro being executed (part of the fingerprint)
+  G4bool Enabled() const { return everyEvents > 0 || everyMinutes > 0.0; }
+};
+
+struct CheckpointState {
+  G4int    runID       = 0;   // run the checkpoint was taken in
+  G4long   runEvents   = 0;   // events requested by that run's beamOn
+  std::string configHash;     // ConfigFingerprint() at checkpoint time
+  G4long   nextEvent   = 0;   // first event ID not yet simulated
+  G4long   eventsSeen  = 0;   // events with at least one layer hit so far
+  G4double totalEdep   = 0.0; // accumulated energy deposit (internal units)
+  std::uintmax_t deflectionBytes  = 0; // size of deflection_results.csv
+  std::uintmax_t uncertaintyBytes = 0; // size of l2_uncertainty.csv
+  std::string rngFile;        // engine status file written with this checkpoint
+};
+
+extern CheckpointConfig gCheckpoint; // global checkpoint config
+extern CheckpointState  gResume;     // state loaded for --resume
+
+// Write RNG state + metadata; the metadata file is replaced atomically so a
+// crash mid-write leaves the previous checkpoint intact.
+G4bool SaveCheckpoint(const CheckpointState& st);
+
+// Read the metadata written by SaveCheckpoint (does not touch the RNG).
+G4bool LoadCheckpoint(CheckpointState& st);
+
+// Restore the RNG engine from the status file referenced by 'st'.
+G4bool RestoreCheckpointRandom(const CheckpointState& st);
+
+// Hash of geometry, beam, readout and macro contents; a resume with a
+// different fingerprint would splice incompatible output.
+std::string ConfigFingerprint();
+
+// True while --resume is replaying runs/events already covered by gResume.
+inline G4bool ResumeSkips(G4int runID, G4long eventID) {
+  return gCheckpoint.resume &&
+         (runID < gResume.runID || (runID == gResume.runID && eventID < gResume.nextEvent));
+}
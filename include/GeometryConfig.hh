@@ -37,8 +37,12 @@ struct StackConfig {
 
 struct BeamConfig { G4double p_MeV; G4double beta; };
 
-extern StackConfig gStack;  // global geometry config
-extern BeamConfig  gBeam;   // global beam config (for MS uncertainty)
+// Pixel grid used when reconstructing hits (coarser 200x200 or future 1000x1000)
+struct ReadoutConfig { G4int nx = 200; G4int ny = 200; };
+
+extern StackConfig   gStack;   // global geometry config
+extern BeamConfig    gBeam;    // global beam config (for MS uncertainty)
+extern ReadoutConfig gReadout; // global readout pixelization
 
 // Ensure custom film materials exist (NbTiN approx, Si3N4, Al2O3)
 void EnsureCustomMaterials();
@@ -0,0 +1,64 @@
+#pragma once
+#include "globals.hh"
+#include <string>
+
+
+// Log levels. Anything above the compile-time ceiling LEKID_LOG_LEVEL sits in
+// a discarded 'if constexpr' branch and generates no code at all.
+#define LEKID_LOG_OFF   0
+#define LEKID_LOG_ERROR 1
+#define LEKID_LOG_WARN  2
+#define LEKID_LOG_INFO  3
+#define LEKID_LOG_DEBUG 4
+#define LEKID_LOG_TRACE 5
+
+#ifndef LEKID_LOG_LEVEL
+#define LEKID_LOG_LEVEL LEKID_LOG_INFO
+#endif
+
+// Runtime-selectable categories (bit mask)
+enum LogCategory : unsigned {
+  kLogGeometry = 1u << 0, // volumes, boundaries, construction
+  kLogHits     = 1u << 1, // layer entries, energy deposit
+  kLogReco     = 1u << 2, // L2 prediction / pixelization
+  kLogIO       = 1u << 3, // run lifecycle, output files, checkpoints
+  kLogAll      = kLogGeometry | kLogHits | kLogReco | kLogIO
+};
+
+struct LogConfig {
+  // Runtime threshold: info, or the compile-time ceiling if that is lower
+  G4int    level       = LEKID_LOG_LEVEL < LEKID_LOG_INFO ? LEKID_LOG_LEVEL : LEKID_LOG_INFO;
+  unsigned categories  = kLogAll;
+  G4long   sampleEvery = 1;              // per-event messages for 1 in N events only
+  G4long   currentEvent = -1;            // set by EventAction; -1 outside the event loop
+};
+
+extern LogConfig gLog; // global logging config
+
+// Errors are filtered by level only; everything else also by category and sampling.
+inline bool LogEnabled(int level, unsigned category) {
+  if (level > gLog.level) return false;
+  if (level <= LEKID_LOG_ERROR) return true;
+  if (!(gLog.categories & category)) return false;
+  return gLog.sampleEvery <= 1 || gLog.currentEvent < 0 || gLog.currentEvent % gLog.sampleEvery == 0;
+}
+
+// "error".."trace" or "off"
+G4bool ParseLogLevel(const std::string& name, G4int& level);
+const char* LogLevelName(G4int level);
+
+// Comma-separated list of geometry, hits, reco, io, or "all" / "none"
+G4bool ParseLogCategories(const std::string& list, unsigned& mask);
+
+#define LEKID_LOG_TO(stream, lvl, cat, msg)                                  \
+  do {                                                                       \
+    if constexpr ((lvl) <= LEKID_LOG_LEVEL) {                                \
+      if (LogEnabled((lvl), (cat))) { stream << msg << G4endl; }             \
+    }                                                                        \
+  } while (0)
+
+#define LEKID_ERROR(cat, msg) LEKID_LOG_TO(G4cerr, LEKID_LOG_ERROR, cat, msg)
+#define LEKID_WARN(cat, msg)  LEKID_LOG_TO(G4cerr, LEKID_LOG_WARN,  cat, msg)
+#define LEKID_INFO(cat, msg)  LEKID_LOG_TO(G4cout, LEKID_LOG_INFO,  cat, msg)
+#define LEKID_DEBUG(cat, msg) LEKID_LOG_TO(G4cout, LEKID_LOG_DEBUG, cat, msg)
+#define LEKID_TRACE(cat, msg) LEKID_LOG_TO(G4cout, LEKID_LOG_TRACE, cat, msg)
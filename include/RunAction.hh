@@ -2,6 +2,8 @@
 #define RunAction_h 1
 #include "G4UserRunAction.hh"
 #include "G4ThreeVector.hh"
+#include <chrono>
+#include <fstream>
 #include <map>
 #include <string>
 
@@ -14,11 +16,24 @@ public:
   ~RunAction() override;
   void BeginOfRunAction(const G4Run*) override;
   void EndOfRunAction(const G4Run*) override;
+  void EndOfEvent(long eventID);
   void AddEdep(double edep) { totalEdep += edep; }
   void SetLayerHit(long eventID, const std::string& layer, const G4ThreeVector& pos);
   void RecordLayer2Actual(long eventID, const G4ThreeVector& pos);
 private:
+  void OpenOutputs();
+  void WriteEvents();
+  void Checkpoint(long nextEvent);
+
   double totalEdep = 0.0;
   std::map<long, std::map<std::string, HitPos>> eventHits;
+  std::ofstream deflOut;  // deflection_results.csv
+  std::ofstream uncOut;   // l2_uncertainty.csv
+  long eventsSeen = 0;    // events already reconstructed and written
+  long eventsSinceCheckpoint = 0;
+  int  runID = 0;         // current G4Run ID
+  long runEvents = 0;     // events requested by the current beamOn
+  bool skipRun = false;   // --resume: run lies before the checkpointed one
+  std::chrono::steady_clock::time_point lastCheckpoint;
 };
 #endif
@@ -1,11 +1,15 @@
 #ifndef SteppingAction_h
 #define SteppingAction_h 1
 #include "G4UserSteppingAction.hh"
+#include "globals.hh"
 class G4Step;
 class SteppingAction : public G4UserSteppingAction {
 public:
   SteppingAction();
   ~SteppingAction() override;
   void UserSteppingAction(const G4Step*) override;
+  G4long GetStepCount() const { return fStepCount; }
+private:
+  G4long fStepCount = 0; // all steps seen by this action (for benchmarks)
 };
 #endif
@@ -1,12 +1,15 @@
 #include "ActionInitialization.hh"
 #include "PrimaryGeneratorAction.hh"
 #include "RunAction.hh"
+#include "EventAction.hh"
 #include "SteppingAction.hh"
 
 ActionInitialization::ActionInitialization() : G4VUserActionInitialization() {}
 ActionInitialization::~ActionInitialization() {}
 void ActionInitialization::Build() const {
   SetUserAction(new PrimaryGeneratorAction());
-  SetUserAction(new RunAction());
+  auto* runAction = new RunAction();
+  SetUserAction(runAction);
+  SetUserAction(new EventAction(runAction));
   SetUserAction(new SteppingAction());
 }
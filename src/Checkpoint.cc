@@ -0,0 +1,119 @@
+#include "Checkpoint.hh"
+#include "GeometryConfig.hh"
+#include "Logging.hh"
+#include "Randomize.hh"
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <system_error>
+
+CheckpointConfig gCheckpoint;
+CheckpointState  gResume;
+
+// Engine file referenced by the last committed checkpoint (deleted once superseded)
+static std::string gLastRngFile;
+
+G4bool SaveCheckpoint(const CheckpointState& st) {
+  namespace fs = std::filesystem;
+  std::error_code ec;
+
+  // RNG state goes to a per-checkpoint file so the metadata never points at a
+  // half-written engine status.
+  const std::string rngFile = gCheckpoint.path + "." + std::to_string(st.runID) + "." +
+                              std::to_string(st.nextEvent) + ".rng";
+  G4Random::saveEngineStatus(rngFile.c_str());
+  if (!fs::exists(rngFile, ec)) {
+    LEKID_ERROR(kLogIO, "[Checkpoint] could not write " << rngFile);
+    return false;
+  }
+
+  const std::string tmp = gCheckpoint.path + ".tmp";
+  {
+    std::ofstream out(tmp, std::ios::trunc);
+    out << std::setprecision(17)
+        << "run_id "            << st.runID << '\n'
+        << "run_events "        << st.runEvents << '\n'
+        << "config_hash "       << st.configHash << '\n'
+        << "next_event "        << st.nextEvent << '\n'
+        << "events_seen "       << st.eventsSeen << '\n'
+        << "total_edep "        << st.totalEdep << '\n'
+        << "deflection_bytes "  << st.deflectionBytes << '\n'
+        << "uncertainty_bytes " << st.uncertaintyBytes << '\n'
+        << "rng_file "          << rngFile << '\n';
+    if (!out) {
+      LEKID_ERROR(kLogIO, "[Checkpoint] could not write " << tmp);
+      return false;
+    }
+  }
+  fs::rename(tmp, gCheckpoint.path, ec);
+  if (ec) {
+    LEKID_ERROR(kLogIO, "[Checkpoint] rename to " << gCheckpoint.path << " failed: " << ec.message());
+    return false;
+  }
+
+  // Previous engine file is no longer referenced (on resume: the one resumed from)
+  if (gLastRngFile.empty()) gLastRngFile = gResume.rngFile;
+  if (!gLastRngFile.empty() && gLastRngFile != rngFile) fs::remove(gLastRngFile, ec);
+  gLastRngFile = rngFile;
+  return true;
+}
+
+G4bool LoadCheckpoint(CheckpointState& st) {
+  std::ifstream in(gCheckpoint.path);
+  if (!in) {
+    LEKID_ERROR(kLogIO, "[Checkpoint] cannot open " << gCheckpoint.path);
+    return false;
+  }
+  CheckpointState s;
+  std::string key;
+  while (in >> key) {
+    if      (key == "run_id")            in >> s.runID;
+    else if (key == "run_events")        in >> s.runEvents;
+    else if (key == "config_hash")       in >> s.configHash;
+    else if (key == "next_event")        in >> s.nextEvent;
+    else if (key == "events_seen")       in >> s.eventsSeen;
+    else if (key == "total_edep")        in >> s.totalEdep;
+    else if (key == "deflection_bytes")  in >> s.deflectionBytes;
+    else if (key == "uncertainty_bytes") in >> s.uncertaintyBytes;
+    else if (key == "rng_file")          in >> s.rngFile;
+    else { std::string skip; std::getline(in, skip); }
+  }
+  if (s.rngFile.empty() || s.configHash.empty()) {
+    LEKID_ERROR(kLogIO, "[Checkpoint] " << gCheckpoint.path << " is incomplete");
+    return false;
+  }
+  st = s;
+  return true;
+}
+
+G4bool RestoreCheckpointRandom(const CheckpointState& st) {
+  std::error_code ec;
+  if (!std::filesystem::exists(st.rngFile, ec)) {
+    LEKID_ERROR(kLogIO, "[Checkpoint] missing RNG state " << st.rngFile);
+    return false;
+  }
+  G4Random::restoreEngineStatus(st.rngFile.c_str());
+  return true;
+}
+
+std::string ConfigFingerprint() {
+  std::ostringstream os;
+  os << std::setprecision(17);
+  for (const auto& fs : gStack.layer) {
+    os << fs.chipXY << ' ' << fs.siThickness << ' ' << fs.nbtiN_thick << ' ' << fs.al_thick << ' '
+       << fs.al_length << ' ' << fs.al_width << ' ' << fs.al2o3_thick << ' ' << fs.sin_thick << ' '
+       << fs.use_nbtiN << fs.use_al << fs.use_al2o3 << fs.use_sin << '\n';
+  }
+  os << gStack.gap12 << ' ' << gStack.gap23 << '\n'
+     << gBeam.p_MeV << ' ' << gBeam.beta << '\n'
+     << gReadout.nx << ' ' << gReadout.ny << '\n';
+  if (!gCheckpoint.macro.empty()) os << std::ifstream(gCheckpoint.macro).rdbuf();
+
+  // FNV-1a, 64 bit
+  std::uint64_t h = 1469598103934665603ull;
+  for (unsigned char c : os.str()) { h ^= c; h *= 1099511628211ull; }
+  std::ostringstream hex;
+  hex << std::hex << std::setw(16) << std::setfill('0') << h;
+  return hex.str();
+}
@@ -1,5 +1,6 @@
 #include "DetectorConstruction.hh"
 #include "GeometryConfig.hh"
+#include "Logging.hh"
 #include "G4NistManager.hh"
 #include "G4Material.hh"
 #include "G4LogicalVolume.hh"
@@ -38,8 +39,8 @@ G4VPhysicalVolume* DetectorConstruction::Construct() {
   BuildLayerStack("Layer2", gStack.layer[1], worldLV, G4ThreeVector(0,0,z2));
   BuildLayerStack("Layer3", gStack.layer[2], worldLV, G4ThreeVector(0,0,z3));
 
-  G4cout << ">>> DetectorConstruction COMPLETE: z1=" << z1 / mm
-      << " mm, z2=" << z2 / mm << " mm, z3=" << z3 / mm << " mm" << G4endl;
+  LEKID_INFO(kLogGeometry, ">>> DetectorConstruction COMPLETE: z1=" << z1 / mm
+      << " mm, z2=" << z2 / mm << " mm, z3=" << z3 / mm << " mm");
 
   return worldPV;
 }
@@ -0,0 +1,14 @@
+#include "EventAction.hh"
+#include "RunAction.hh"
+#include "Logging.hh"
+#include "G4Event.hh"
+
+EventAction::EventAction(RunAction* runAction) : G4UserEventAction(), fRunAction(runAction) {}
+EventAction::~EventAction() {}
+void EventAction::BeginOfEventAction(const G4Event* event) {
+  gLog.currentEvent = event->GetEventID(); // drives 1-in-N log sampling
+}
+void EventAction::EndOfEventAction(const G4Event* event) {
+  gLog.currentEvent = -1;
+  fRunAction->EndOfEvent(event->GetEventID());
+}
@@ -13,8 +13,9 @@
 #include <algorithm>
 #include <cmath>
 
-StackConfig gStack;
-BeamConfig  gBeam = { 4000*MeV, 1.0 };
+StackConfig   gStack;
+BeamConfig    gBeam = { 4000*MeV, 1.0 };
+ReadoutConfig gReadout;
 
 void EnsureCustomMaterials() {
   auto* nist = G4NistManager::Instance();
@@ -0,0 +1,34 @@
+#include "Logging.hh"
+#include <sstream>
+
+LogConfig gLog;
+
+static const char* const kLevelNames[] = { "off", "error", "warn", "info", "debug", "trace" };
+
+G4bool ParseLogLevel(const std::string& name, G4int& level) {
+  for (G4int i = LEKID_LOG_OFF; i <= LEKID_LOG_TRACE; ++i) {
+    if (name == kLevelNames[i]) { level = i; return true; }
+  }
+  return false;
+}
+
+const char* LogLevelName(G4int level) {
+  return (level >= LEKID_LOG_OFF && level <= LEKID_LOG_TRACE) ? kLevelNames[level] : "unknown";
+}
+
+G4bool ParseLogCategories(const std::string& list, unsigned& mask) {
+  unsigned m = 0;
+  std::stringstream ss(list);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if      (item == "geometry") m |= kLogGeometry;
+    else if (item == "hits")     m |= kLogHits;
+    else if (item == "reco" || item == "reconstruction") m |= kLogReco;
+    else if (item == "io")       m |= kLogIO;
+    else if (item == "all")      m |= kLogAll;
+    else if (item == "none")     continue;
+    else return false;
+  }
+  mask = m;
+  return true;
+}
@@ -8,6 +8,9 @@
 #include "Randomize.hh"
 #include "G4PhysicalConstants.hh" 
 #include "GeometryConfig.hh"
+#include "Checkpoint.hh"
+#include "G4RunManager.hh"
+#include "G4Run.hh"
 #include <cmath>
 
 PrimaryGeneratorAction::PrimaryGeneratorAction() : G4VUserPrimaryGeneratorAction() {
@@ -22,8 +25,13 @@ PrimaryGeneratorAction::PrimaryGeneratorAction() : G4VUserPrimaryGeneratorAction
 }
 PrimaryGeneratorAction::~PrimaryGeneratorAction() { delete fParticleGun; }
 void PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent) {
-    
- 
+        // On --resume, runs/events already covered by the checkpoint stay empty so
+        // the RNG stream (restored in BeginOfRunAction) lines up with the next event.
+        if (gCheckpoint.resume) {
+            const G4Run* run = G4RunManager::GetRunManager()->GetCurrentRun();
+            if (run && ResumeSkips(run->GetRunID(), anEvent->GetEventID())) return;
+        }
+
         // --- Random starting position across the chip (uniform in x,y) ---
         double halfSize = gStack.layer[0].chipXY * 0.5;   // chip half-width in mm
         G4double x0 = (2 * G4UniformRand() - 1.0) * halfSize;
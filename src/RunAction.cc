@@ -5,24 +5,16 @@
 #include "G4SystemOfUnits.hh"
 #include "G4Material.hh"
 #include "G4ThreeVector.hh"
+#include "Checkpoint.hh"
+#include "Logging.hh"
 #include <fstream>
 #include <iomanip>
 #include <algorithm>
 #include <cmath>
 #include <filesystem>
+#include <system_error>
 
 
-static std::ofstream& UncStream() {
-    static std::ofstream ofs;
-    if (!ofs.is_open()) {
-        ofs.open("l2_uncertainty.csv", std::ios::trunc);
-        ofs << "event,L2_pred_pixcenter_x_mm,L2_pred_pixcenter_y_mm,i_pred,j_pred,"
-            "sigma_x_mm,sigma_y_mm,sigma_r_mm,r95_mm,sigma_r_px,r95_px,crossesAl\n";
-
-    }
-    return ofs;
-}
-
  
 static inline G4ThreeVector PredictL2Pixelized(const G4ThreeVector& p1, double z1,
     const G4ThreeVector& p3, double z3,
@@ -55,33 +47,151 @@ static inline G4ThreeVector PredictL2Pixelized(const G4ThreeVector& p1, double z
 RunAction::RunAction() : G4UserRunAction() {}
 RunAction::~RunAction() {}
 
-void RunAction::BeginOfRunAction(const G4Run*) {
+void RunAction::BeginOfRunAction(const G4Run* run) {
+    runID = run->GetRunID();
+    runEvents = run->GetNumberOfEventToBeProcessed();
+    skipRun = gCheckpoint.resume && runID < gResume.runID;
+    if (skipRun) {
+        // Replayed only to reach the checkpointed run; leave the outputs alone
+        LEKID_INFO(kLogIO, ">>> Skipping run " << runID << " (resuming run " << gResume.runID << ")");
+        return;
+    }
+
     totalEdep = 0.0;
     eventHits.clear();
-    G4cout << ">>> BeginOfRunAction CALLED" << G4endl;
+    eventsSeen = 0;
+    eventsSinceCheckpoint = 0;
+    lastCheckpoint = std::chrono::steady_clock::now();
+
+    if (gCheckpoint.resume) {
+        if (runID != gResume.runID || runEvents != gResume.runEvents ||
+            ConfigFingerprint() != gResume.configHash) {
+            G4Exception("RunAction::BeginOfRunAction", "Checkpoint003", FatalException,
+                ("Checkpoint was taken in run " + std::to_string(gResume.runID) + " of " +
+                 std::to_string(gResume.runEvents) + " events with config " + gResume.configHash +
+                 "; this is run " + std::to_string(runID) + " of " + std::to_string(runEvents) +
+                 " events with config " + ConfigFingerprint() + ".").c_str());
+        }
+        // Drop anything written after the checkpoint, then continue from there
+        if (!RestoreCheckpointRandom(gResume)) {
+            G4Exception("RunAction::BeginOfRunAction", "Checkpoint001", FatalException,
+                "Cannot restore RNG state for --resume.");
+        }
+        // Outputs may only shrink back to the checkpoint; a shorter file (e.g.
+        // truncated by a restart without --resume) would be padded with NULs.
+        const std::pair<const char*, std::uintmax_t> outputs[] = {
+            { "deflection_results.csv", gResume.deflectionBytes },
+            { "l2_uncertainty.csv", gResume.uncertaintyBytes } };
+        auto rewindFailed = [](const char* file, std::uintmax_t bytes, const std::string& why) {
+            G4Exception("RunAction::BeginOfRunAction", "Checkpoint002", FatalException,
+                (std::string("Cannot rewind ") + file + " to checkpoint size " +
+                 std::to_string(bytes) + ": " + why).c_str());
+        };
+        for (const auto& [file, bytes] : outputs) {
+            std::error_code ec;
+            const std::uintmax_t onDisk = std::filesystem::file_size(file, ec);
+            if (ec) rewindFailed(file, bytes, ec.message());
+            else if (onDisk < bytes)
+                rewindFailed(file, bytes, "only " + std::to_string(onDisk) + " bytes on disk, output was overwritten");
+        }
+        for (const auto& [file, bytes] : outputs) {
+            std::error_code ec;
+            std::filesystem::resize_file(file, bytes, ec);
+            if (ec) rewindFailed(file, bytes, ec.message());
+        }
+        totalEdep = gResume.totalEdep;
+        eventsSeen = gResume.eventsSeen;
+        LEKID_INFO(kLogIO, ">>> Resuming from " << gCheckpoint.path << " at run " << runID
+            << ", event " << gResume.nextEvent);
+    }
+    OpenOutputs();
+    LEKID_INFO(kLogIO, ">>> BeginOfRunAction CALLED");
 }
 
 
 void RunAction::EndOfRunAction(const G4Run*) {
-    G4cout << ">>> EndOfRunAction CALLED" << G4endl;
-    G4cout << "Total energy deposited: " << G4BestUnit(totalEdep, "Energy") << G4endl;
-    G4cout << "[RunAction] CWD = " << std::filesystem::current_path().string() << G4endl;
+    if (skipRun) { skipRun = false; return; }
+    LEKID_INFO(kLogIO, ">>> EndOfRunAction CALLED");
+    LEKID_INFO(kLogHits, "Total energy deposited: " << G4BestUnit(totalEdep, "Energy"));
+    LEKID_INFO(kLogIO, "[RunAction] CWD = " << std::filesystem::current_path().string());
 
+    WriteEvents();
+    deflOut.close();
+    uncOut.close();
+    gCheckpoint.resume = false;
 
-    std::ofstream out("deflection_results.csv");
-    out << "eventID,l1_x_mm,l1_y_mm,l1_z_mm,l3_x_mm,l3_y_mm,l3_z_mm,"
-        "pred_x_mm,pred_y_mm,pred_z_mm,act2_x_mm,act2_y_mm,act2_z_mm,err_mm,"
-        "px1,py1,px3,py3,pixel_pred_x,pixel_pred_y,pixel_act_x,pixel_act_y,"
-        "px1_mm,py1_mm,px3_mm,py3_mm,pixel_pred_x_mm,pixel_pred_y_mm,pixel_act_x_mm,pixel_act_y_mm\n";
+    LEKID_INFO(kLogIO, "Wrote deflection_results.csv and l2_uncertainty.csv for " << eventsSeen << " events.");
+}
 
 
+void RunAction::EndOfEvent(long eventID) {
+    if (!gCheckpoint.Enabled()) return;
+    if (skipRun || ResumeSkips(runID, eventID)) return; // replayed on resume
+
+    ++eventsSinceCheckpoint;
+    bool due = gCheckpoint.everyEvents > 0 && eventsSinceCheckpoint >= gCheckpoint.everyEvents;
+    if (!due && gCheckpoint.everyMinutes > 0) {
+        std::chrono::duration<double, std::ratio<60>> elapsed = std::chrono::steady_clock::now() - lastCheckpoint;
+        due = elapsed.count() >= gCheckpoint.everyMinutes;
+    }
+    if (due) Checkpoint(eventID + 1);
+}
+
+
+void RunAction::Checkpoint(long nextEvent) {
+    // Everything up to nextEvent-1 is complete: reconstruct it now so the
+    // checkpoint only has to remember where the files end.
+    WriteEvents();
+    deflOut.flush();
+    uncOut.flush();
+
+    CheckpointState st;
+    st.runID = runID;
+    st.runEvents = runEvents;
+    st.configHash = ConfigFingerprint();
+    st.nextEvent = nextEvent;
+    st.eventsSeen = eventsSeen;
+    st.totalEdep = totalEdep;
+    st.deflectionBytes = static_cast<std::uintmax_t>(deflOut.tellp());
+    st.uncertaintyBytes = static_cast<std::uintmax_t>(uncOut.tellp());
+    if (SaveCheckpoint(st))
+        LEKID_INFO(kLogIO, "[Checkpoint] event " << nextEvent << " -> " << gCheckpoint.path);
+
+    eventsSinceCheckpoint = 0;
+    lastCheckpoint = std::chrono::steady_clock::now();
+}
+
+
+void RunAction::OpenOutputs() {
+    if (gCheckpoint.resume) {
+        deflOut.open("deflection_results.csv", std::ios::app);
+        uncOut.open("l2_uncertainty.csv", std::ios::app);
+    }
+    else {
+        deflOut.open("deflection_results.csv", std::ios::trunc);
+        deflOut << "eventID,l1_x_mm,l1_y_mm,l1_z_mm,l3_x_mm,l3_y_mm,l3_z_mm,"
+            "pred_x_mm,pred_y_mm,pred_z_mm,act2_x_mm,act2_y_mm,act2_z_mm,err_mm,"
+            "px1,py1,px3,py3,pixel_pred_x,pixel_pred_y,pixel_act_x,pixel_act_y,"
+            "px1_mm,py1_mm,px3_mm,py3_mm,pixel_pred_x_mm,pixel_pred_y_mm,pixel_act_x_mm,pixel_act_y_mm\n";
+
+        uncOut.open("l2_uncertainty.csv", std::ios::trunc);
+        uncOut << "event,L2_pred_pixcenter_x_mm,L2_pred_pixcenter_y_mm,i_pred,j_pred,"
+            "sigma_x_mm,sigma_y_mm,sigma_r_mm,r95_mm,sigma_r_px,r95_px,crossesAl\n";
+    }
+    // tellp() must report byte offsets for the checkpoint
+    deflOut.seekp(0, std::ios::end);
+    uncOut.seekp(0, std::ios::end);
+    deflOut << std::fixed << std::setprecision(6);
+}
 
-    out << std::fixed << std::setprecision(6);
 
+// Reconstruct all buffered events, append them to the CSVs and release them.
+void RunAction::WriteEvents() {
+    auto& out = deflOut;
     const auto& fs1 = gStack.layer[0];
     const auto& fs2 = gStack.layer[1];
     double chipXY_mm = fs1.chipXY / mm;
-    int nx = 200, ny = 200; // pixel grid (coarser 200x200 or future 1000x1000)
+    int nx = gReadout.nx, ny = gReadout.ny; // pixel grid
     double pitch_mm = chipXY_mm / nx;
 
     // Substrate centers used in DetectorConstruction
@@ -103,9 +213,12 @@ void RunAction::EndOfRunAction(const G4Run*) {
     double z2_plane = entryZ(fs2, z2c);   // TOP of the full L2 stack
 
 
+    // Per-event reco diagnostics follow the event's own 1-in-N sampling
+    const G4long loggedEvent = gLog.currentEvent;
     for (const auto& evPair : eventHits) {
         long eventID = evPair.first;
         const auto& layerMap = evPair.second;
+        gLog.currentEvent = eventID;
 
         auto it1 = layerMap.find("Layer1");
         auto it3 = layerMap.find("Layer3");
@@ -113,7 +226,10 @@ void RunAction::EndOfRunAction(const G4Run*) {
         bool hasL3 = (it3 != layerMap.end() && it3->second.has);
         auto it2 = layerMap.find("Layer2");
         bool hasAct2 = (it2 != layerMap.end() && it2->second.has);
-        if (!hasL1 || !hasL3) continue;
+        if (!hasL1 || !hasL3) {
+            LEKID_DEBUG(kLogReco, "[reco evt " << eventID << "] skipped: L1 hit " << hasL1 << ", L3 hit " << hasL3);
+            continue;
+        }
 
         G4ThreeVector p1 = it1->second.pos;
         G4ThreeVector p3 = it3->second.pos;
@@ -183,6 +299,12 @@ void RunAction::EndOfRunAction(const G4Run*) {
         auto [ppx_mm, ppy_mm] = toPixelMM(ppx_i, ppy_i);
         auto [pa2_mm, pya2_mm] = toPixelMM(pa2_i, pya2_i);
 
+        LEKID_TRACE(kLogReco, "[reco evt " << eventID << "] L1 px (" << px1_i << "," << py1_i
+            << "), L3 px (" << px3_i << "," << py3_i << "), t_rad = " << t_rad
+            << ", theta0 = " << theta0 << " rad");
+        LEKID_DEBUG(kLogReco, "[reco evt " << eventID << "] L2 pred (" << pred2.x() / mm << ", "
+            << pred2.y() / mm << ") mm px (" << ppx_i << "," << ppy_i << "), act px ("
+            << pa2_i << "," << pya2_i << "), err = " << err << " mm, sigma_r = " << sigma_r / mm << " mm");
 
         out << eventID << ','
             << p1.x() / mm << ',' << p1.y() / mm << ',' << p1.z() / mm << ','
@@ -199,7 +321,7 @@ void RunAction::EndOfRunAction(const G4Run*) {
 
 
 
-        auto& ufs = UncStream();
+        auto& ufs = uncOut;
         ufs << eventID << ','
             << ppx_mm << ',' << ppy_mm << ','   // pixelized predicted coords in mm
             << i_pred << ',' << j_pred << ','   // pixel indices
@@ -210,12 +332,10 @@ void RunAction::EndOfRunAction(const G4Run*) {
 
     }
 
-    out.close();
-
-    UncStream().flush();
-    UncStream().close();
+    gLog.currentEvent = loggedEvent;
 
-    G4cout << "Wrote deflection_results.csv and l2_uncertainty.csv for " << eventHits.size() << " events." << G4endl;
+    eventsSeen += static_cast<long>(eventHits.size());
+    eventHits.clear();
 }
 
 
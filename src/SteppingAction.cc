@@ -5,17 +5,19 @@
 #include "G4RunManager.hh"
 #include "G4EventManager.hh"
 #include "RunAction.hh"
+#include "Logging.hh"
 #include "G4StepPoint.hh"
 #include "G4SystemOfUnits.hh"  // only needed if you print mm; harmless to keep
 
 
 SteppingAction::SteppingAction() : G4UserSteppingAction() {
-    G4cout << ">>> SteppingAction CONSTRUCTED" << G4endl;
+    LEKID_DEBUG(kLogGeometry, ">>> SteppingAction CONSTRUCTED");
 }
 SteppingAction::~SteppingAction() {}
 
 void SteppingAction::UserSteppingAction(const G4Step* step) {
-    G4cout << "[DEBUG] stepping..." << G4endl;
+    ++fStepCount;
+    LEKID_TRACE(kLogGeometry, "[TRACE] stepping...");
     // Post step point & true boundary check (entrance to a new volume)
     const auto post = step->GetPostStepPoint();
     if (!post) return;
@@ -31,13 +33,11 @@ void SteppingAction::UserSteppingAction(const G4Step* step) {
     auto* postVol = post ? post->GetPhysicalVolume() : nullptr;
     if (!postVol) return;
 
-    const std::string preName = preVol ? preVol->GetName() : "";
-    const std::string postName = postVol ? postVol->GetName() : "";
+    const G4String& postName = postVol->GetName();
 
     // Log the actual boundary we crossed
-    G4cout << "[BOUNDARY] " << (preName.empty() ? "NULL" : preName)
-        << " -> " << (postName.empty() ? "NULL" : postName)
-        << "  z=" << post->GetPosition().z() / mm << " mm" << G4endl;
+    LEKID_TRACE(kLogGeometry, "[BOUNDARY] " << (preVol ? preVol->GetName() : G4String("NULL"))
+        << " -> " << postName << "  z=" << post->GetPosition().z() / mm << " mm");
 
 
     // Current event ID
@@ -47,11 +47,11 @@ void SteppingAction::UserSteppingAction(const G4Step* step) {
     // RunAction access (GetUserRunAction returns a const base ptr)
     auto* rm = G4RunManager::GetRunManager();
     const G4UserRunAction* baseUA = rm ? rm->GetUserRunAction() : nullptr;
-    if (!baseUA) { G4cout << "[DEBUG] No RunAction yet\n"; return; }
+    if (!baseUA) { LEKID_WARN(kLogHits, "[SteppingAction] No RunAction yet"); return; }
 
     // cast to your concrete RunAction and drop constness
     auto* runAct = const_cast<RunAction*>(dynamic_cast<const RunAction*>(baseUA));
-    if (!runAct) { G4cout << "[DEBUG] RunAction cast failed\n"; return; }
+    if (!runAct) { LEKID_WARN(kLogHits, "[SteppingAction] RunAction cast failed"); return; }
 
 
     // (optional) keep your energy accumulation
@@ -61,25 +61,25 @@ void SteppingAction::UserSteppingAction(const G4Step* step) {
 
     // Only accept FIRST entry into actual films/Si (not mother volumes).
     // For downward beam, this makes the topmost film the layer's reference plane.
-    const std::string& name = postName;
+    const G4String& name = postName;
 
     if (name == "Layer1_AlStrip_phys" || name == "Layer1_Al2O3_phys" ||
         name == "Layer1_SiN_phys" || name == "Layer1_NbTiN_phys" ||
         name == "Layer1_Si_phys") {
         runAct->SetLayerHit(eventID, "Layer1", pos);
-        G4cout << "[evt " << eventID << "] ENTER L1 (film/Si) at " << pos / mm << " mm" << G4endl;
+        LEKID_DEBUG(kLogHits, "[evt " << eventID << "] ENTER L1 (film/Si) at " << pos / mm << " mm");
     }
     else if (name == "Layer2_AlStrip_phys" || name == "Layer2_Al2O3_phys" ||
         name == "Layer2_SiN_phys" || name == "Layer2_NbTiN_phys" ||
         name == "Layer2_Si_phys") {
         runAct->RecordLayer2Actual(eventID, pos);
-        G4cout << "[evt " << eventID << "] ENTER L2 (film/Si) at " << pos / mm << " mm" << G4endl;
+        LEKID_DEBUG(kLogHits, "[evt " << eventID << "] ENTER L2 (film/Si) at " << pos / mm << " mm");
     }
     else if (name == "Layer3_AlStrip_phys" || name == "Layer3_Al2O3_phys" ||
         name == "Layer3_SiN_phys" || name == "Layer3_NbTiN_phys" ||
         name == "Layer3_Si_phys") {
         runAct->SetLayerHit(eventID, "Layer3", pos);
-        G4cout << "[evt " << eventID << "] ENTER L3 (film/Si) at " << pos / mm << " mm" << G4endl;
+        LEKID_DEBUG(kLogHits, "[evt " << eventID << "] ENTER L3 (film/Si) at " << pos / mm << " mm");
     }
 
 
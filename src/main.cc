@@ -4,10 +4,75 @@
 #include "G4UIExecutive.hh"
 #include "DetectorConstruction.hh"
 #include "ActionInitialization.hh"
+#include "Checkpoint.hh"
+#include "Logging.hh"
 #include "G4PhysListFactory.hh"
 #include "G4EmStandardPhysics_option4.hh"
+#include <cstdlib>
+#include <string>
+
+// Strictly positive number, rejecting trailing junk such as "10k"
+static bool ParsePositive(const char* text, G4long& value) {
+  char* end = nullptr;
+  const long v = std::strtol(text, &end, 10);
+  if (end == text || *end != '\0' || v <= 0) return false;
+  value = v;
+  return true;
+}
+
+static bool ParsePositive(const char* text, G4double& value) {
+  char* end = nullptr;
+  const double v = std::strtod(text, &end);
+  if (end == text || *end != '\0' || !(v > 0)) return false;
+  value = v;
+  return true;
+}
+
+static void PrintUsage(const char* exe) {
+  G4cerr << "Usage: " << exe << " [options] [macro]\n"
+         << "  --checkpoint-every <N>     checkpoint every N events\n"
+         << "  --checkpoint-minutes <T>   checkpoint every T minutes of wall time\n"
+         << "  --checkpoint-file <path>   checkpoint metadata file (default lekid.ckpt)\n"
+         << "  --resume                   continue from the checkpoint file\n"
+         << "  --log-level <level>        off|error|warn|info|debug|trace (default info or build level)\n"
+         << "  --log-categories <list>    comma list of geometry,hits,reco,io (default all)\n"
+         << "  --log-sample <N>           per-event messages for 1 in N events only\n"
+         << "Without a macro an interactive session runs vis.mac." << G4endl;
+}
 
 int main(int argc, char** argv) {
+  // Options first; the first non-option argument is the macro to execute
+  G4String macro;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool hasValue = i + 1 < argc;
+    if (arg == "--checkpoint-every" && hasValue) {
+      if (!ParsePositive(argv[++i], gCheckpoint.everyEvents)) { PrintUsage(argv[0]); return 1; }
+    }
+    else if (arg == "--checkpoint-minutes" && hasValue) {
+      if (!ParsePositive(argv[++i], gCheckpoint.everyMinutes)) { PrintUsage(argv[0]); return 1; }
+    }
+    else if (arg == "--checkpoint-file" && hasValue)    gCheckpoint.path = argv[++i];
+    else if (arg == "--resume")                         gCheckpoint.resume = true;
+    else if (arg == "--log-sample" && hasValue)         gLog.sampleEvery = std::atol(argv[++i]);
+    else if (arg == "--log-level" && hasValue) {
+      if (!ParseLogLevel(argv[++i], gLog.level)) { PrintUsage(argv[0]); return 1; }
+    }
+    else if (arg == "--log-categories" && hasValue) {
+      if (!ParseLogCategories(argv[++i], gLog.categories)) { PrintUsage(argv[0]); return 1; }
+    }
+    else if (arg.rfind("--", 0) == 0 || !macro.empty()) { PrintUsage(argv[0]); return 1; }
+    else macro = arg;
+  }
+  gCheckpoint.macro = macro;
+  if (gLog.level > LEKID_LOG_LEVEL)
+    G4cerr << "Note: log level capped at compile-time level '" << LogLevelName(LEKID_LOG_LEVEL)
+           << "' (reconfigure with -DLEKID_LOG_LEVEL=...)" << G4endl;
+  if (gCheckpoint.resume && !LoadCheckpoint(gResume)) {
+    G4cerr << "Cannot resume: no usable checkpoint at " << gCheckpoint.path << G4endl;
+    return 1;
+  }
+
   auto* runManager = G4RunManagerFactory::CreateRunManager(G4RunManagerType::Serial);
   runManager->SetUserInitialization(new DetectorConstruction());
 
@@ -22,15 +87,14 @@ int main(int argc, char** argv) {
   visManager->Initialize();
 
   G4UImanager* ui = G4UImanager::GetUIpointer();
-  if (argc == 1) {
+  if (macro.empty()) {
     G4UIExecutive* uiExec = new G4UIExecutive(argc, argv);
     ui->ApplyCommand("/control/execute vis.mac");
     uiExec->SessionStart();
     delete uiExec;
   } else {
     G4String command = "/control/execute ";
-    G4String fileName = argv[1];
-    ui->ApplyCommand(command + fileName);
+    ui->ApplyCommand(command + macro);
   }
 
   delete visManager;
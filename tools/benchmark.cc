@@ -0,0 +1,335 @@
+// Throughput benchmark for the LEKID stack.
+//
+// Runs fixed-seed canonical scenarios (one process each, so peak RSS and
+// startup time are per scenario), reports events/s, steps/event, peak RSS,
+// startup time and output bytes/event as JSON, and compares a result file
+// against a stored baseline.
+//
+//   lekid_benchmark --all [--events N] [--seed S] [--json results.json]
+//   lekid_benchmark --scenario <name> [--events N] [--seed S] [--json out.json] [--workdir DIR]
+//
+// Scenarios run in a scratch directory (a fresh temp dir unless --workdir is
+// given), so the CSVs they write never touch the caller's simulation output.
+//   lekid_benchmark --compare baseline.json results.json [--tolerance 0.10]
+
+#include "G4RunManagerFactory.hh"
+#include "G4UImanager.hh"
+#include "G4UIsession.hh"
+#include "G4PhysListFactory.hh"
+#include "G4EmStandardPhysics_option4.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+#include "DetectorConstruction.hh"
+#include "ActionInitialization.hh"
+#include "GeometryConfig.hh"
+#include "SteppingAction.hh"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+struct Scenario {
+  const char* name;
+  const char* description;
+  void (*apply)();
+};
+
+const Scenario kScenarios[] = {
+  { "default", "3-layer stack, default films, 200x200 pixels", [] {} },
+  { "thin_film_off", "bare Si substrates (all films disabled)", [] {
+      for (auto& fs : gStack.layer) { fs.use_nbtiN = false; fs.use_al = false; fs.use_al2o3 = false; fs.use_sin = false; }
+    } },
+  { "sin_enabled", "default stack plus 200 nm SiN passivation", [] {
+      for (auto& fs : gStack.layer) { fs.use_sin = true; fs.sin_thick = 200*nm; }
+    } },
+  { "large_pixel_grid", "default stack, 1000x1000 pixel readout", [] {
+      gReadout.nx = 1000; gReadout.ny = 1000;
+    } },
+};
+
+const Scenario* FindScenario(const std::string& name) {
+  for (const auto& sc : kScenarios)
+    if (name == sc.name) return &sc;
+  return nullptr;
+}
+
+// Swallows G4cout so console formatting does not dominate the measurement
+class SilentSession : public G4UIsession {
+public:
+  G4int ReceiveG4cout(const G4String&) override { return 0; }
+  G4int ReceiveG4cerr(const G4String&) override { return 0; }
+};
+
+double PeakRssMB() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS pmc;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return 0.0;
+  return pmc.PeakWorkingSetSize / (1024.0 * 1024.0);
+#else
+  rusage ru{};
+  getrusage(RUSAGE_SELF, &ru);
+#ifdef __APPLE__
+  return ru.ru_maxrss / (1024.0 * 1024.0); // bytes
+#else
+  return ru.ru_maxrss / 1024.0;            // kilobytes
+#endif
+#endif
+}
+
+std::uintmax_t FileBytes(const char* path) {
+  std::error_code ec;
+  auto n = std::filesystem::file_size(path, ec);
+  return ec ? 0 : n;
+}
+
+// Fresh directory under the system temp dir, unique per call
+std::filesystem::path MakeScratchDir(const std::string& tag) {
+  namespace fs = std::filesystem;
+  const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+  fs::path dir = fs::temp_directory_path() / ("lekid_benchmark_" + tag + "_" + std::to_string(stamp));
+  fs::create_directories(dir);
+  return dir;
+}
+
+using Metrics = std::map<std::string, double>;
+
+// One result object per line; --compare relies on this flat layout.
+std::string ToJson(const std::string& name, const Metrics& m) {
+  std::ostringstream os;
+  os << std::setprecision(10) << "{\"name\": \"" << name << "\"";
+  for (const auto& kv : m) os << ", \"" << kv.first << "\": " << kv.second;
+  os << "}";
+  return os.str();
+}
+
+std::map<std::string, Metrics> ReadResults(const std::string& path) {
+  std::map<std::string, Metrics> out;
+  std::ifstream in(path);
+  if (!in) { std::cerr << "cannot open " << path << "\n"; return out; }
+  static const std::regex kName("\"name\"\\s*:\\s*\"([^\"]*)\"");
+  static const std::regex kNum("\"(\\w+)\"\\s*:\\s*([-+0-9.eE]+)");
+  std::string line;
+  while (std::getline(in, line)) {
+    std::smatch nm;
+    if (!std::regex_search(line, nm, kName)) continue;
+    Metrics& m = out[nm[1]];
+    for (std::sregex_iterator it(line.begin(), line.end(), kNum), end; it != end; ++it)
+      m[(*it)[1]] = std::stod((*it)[2]);
+  }
+  return out;
+}
+
+int RunScenario(const Scenario& sc, long events, long seed, std::string jsonPath,
+                std::string workDir, bool verbose) {
+  namespace fs = std::filesystem;
+  const auto t0 = std::chrono::steady_clock::now();
+
+  // Resolve the result path before leaving the caller's directory
+  if (!jsonPath.empty()) jsonPath = fs::absolute(jsonPath).string();
+  const bool scratch = workDir.empty();
+  std::error_code ec;
+  if (scratch) workDir = MakeScratchDir(sc.name).string();
+  else fs::create_directories(workDir, ec);
+  fs::current_path(workDir, ec);
+  if (ec) { std::cerr << "cannot enter " << workDir << ": " << ec.message() << "\n"; return 2; }
+
+  SilentSession silent;
+  if (!verbose) G4UImanager::GetUIpointer()->SetCoutDestination(&silent);
+
+  G4Random::setTheSeed(seed);
+  sc.apply();
+
+  auto* runManager = G4RunManagerFactory::CreateRunManager(G4RunManagerType::Serial);
+  runManager->SetUserInitialization(new DetectorConstruction());
+  G4PhysListFactory physFactory;
+  auto* phys = physFactory.GetReferencePhysList("FTFP_BERT");
+  phys->ReplacePhysics(new G4EmStandardPhysics_option4());
+  runManager->SetUserInitialization(phys);
+  runManager->SetUserInitialization(new ActionInitialization());
+  runManager->Initialize();
+  runManager->BeamOn(0); // physics tables are built on the first BeamOn: count them as startup
+
+  const auto t1 = std::chrono::steady_clock::now();
+  runManager->BeamOn(static_cast<G4int>(events));
+  const auto t2 = std::chrono::steady_clock::now();
+
+  const auto* stepping = static_cast<const SteppingAction*>(runManager->GetUserSteppingAction());
+  const double runSec = std::chrono::duration<double>(t2 - t1).count();
+  const double n = static_cast<double>(events);
+
+  Metrics m;
+  m["events"] = n;
+  m["seed"] = static_cast<double>(seed);
+  m["startup_s"] = std::chrono::duration<double>(t1 - t0).count();
+  m["run_s"] = runSec;
+  m["events_per_s"] = runSec > 0 ? n / runSec : 0.0;
+  m["steps_per_event"] = stepping ? stepping->GetStepCount() / n : 0.0;
+  m["peak_rss_mb"] = PeakRssMB();
+  m["output_bytes_per_event"] =
+      (FileBytes("deflection_results.csv") + FileBytes("l2_uncertainty.csv")) / n;
+
+  G4UImanager::GetUIpointer()->SetCoutDestination(nullptr);
+  delete runManager;
+
+  const std::string json = ToJson(sc.name, m);
+  std::cout << json << std::endl;
+  if (!jsonPath.empty()) std::ofstream(jsonPath, std::ios::trunc) << json << "\n";
+  if (scratch) {
+    fs::current_path(fs::temp_directory_path(), ec);
+    fs::remove_all(workDir, ec);
+  }
+  return 0;
+}
+
+// Each scenario gets a fresh process: Geant4 geometry and the run manager
+// cannot be rebuilt in-process, and RSS/startup must not leak across runs.
+int RunAll(const char* exe, long events, long seed, const std::string& jsonPath, bool verbose) {
+  namespace fs = std::filesystem;
+  std::vector<std::string> rows;
+  int rc = 0;
+  for (const auto& sc : kScenarios) {
+    const fs::path work = MakeScratchDir(sc.name);
+    const std::string part = (work / "result.json").string();
+    std::ostringstream cmd;
+    cmd << '"' << exe << "\" --scenario " << sc.name << " --events " << events
+        << " --seed " << seed << " --json \"" << part << "\" --workdir \"" << work.string() << '"'
+        << (verbose ? " --verbose" : "");
+    std::cerr << "[benchmark] " << sc.name << ": " << sc.description << std::endl;
+    if (std::system(cmd.str().c_str()) == 0) {
+      std::ifstream in(part);
+      std::string line;
+      if (std::getline(in, line)) rows.push_back(line);
+    }
+    else rc = 1;
+    std::error_code ec;
+    fs::remove_all(work, ec);
+  }
+
+  std::ostringstream os;
+  os << "{\"scenarios\": [\n";
+  for (std::size_t i = 0; i < rows.size(); ++i)
+    os << "  " << rows[i] << (i + 1 < rows.size() ? ",\n" : "\n");
+  os << "]}\n";
+  if (jsonPath.empty()) std::cout << os.str();
+  else std::ofstream(jsonPath, std::ios::trunc) << os.str();
+  return rc;
+}
+
+// Direction in which each metric gets worse; steps/event should not move at all.
+enum class Worse { Lower, Higher, Either };
+
+int Compare(const std::string& basePath, const std::string& curPath, double tol) {
+  const auto base = ReadResults(basePath);
+  const auto cur = ReadResults(curPath);
+  if (base.empty() || cur.empty()) return 2;
+
+  // Per-event metrics are only comparable for the same event sample
+  for (const auto& [name, bm] : base) {
+    auto it = cur.find(name);
+    if (it == cur.end()) continue;
+    for (const char* key : { "events", "seed" }) {
+      auto b = bm.find(key), c = it->second.find(key);
+      if (b == bm.end() || c == it->second.end() || b->second != c->second) {
+        std::cerr << name << ": '" << key << "' differs between " << basePath << " and " << curPath
+                  << "; rerun with the baseline's --events/--seed\n";
+        return 2;
+      }
+    }
+  }
+
+  const std::pair<const char*, Worse> kChecked[] = {
+    { "events_per_s", Worse::Lower },
+    { "steps_per_event", Worse::Either },
+    { "peak_rss_mb", Worse::Higher },
+    { "startup_s", Worse::Higher },
+    { "output_bytes_per_event", Worse::Either },
+  };
+
+  int regressions = 0;
+  std::cout << std::left << std::setw(18) << "scenario" << std::setw(24) << "metric"
+            << std::right << std::setw(14) << "baseline" << std::setw(14) << "current"
+            << std::setw(10) << "change" << "\n";
+  for (const auto& [name, bm] : base) {
+    auto it = cur.find(name);
+    if (it == cur.end()) {
+      std::cout << std::left << std::setw(18) << name << "MISSING from " << curPath << "\n";
+      ++regressions;
+      continue;
+    }
+    for (const auto& [metric, worse] : kChecked) {
+      auto b = bm.find(metric), c = it->second.find(metric);
+      if (b == bm.end() || c == it->second.end() || b->second == 0.0) continue;
+      const double rel = (c->second - b->second) / b->second;
+      const bool bad = (worse == Worse::Lower  && rel < -tol) ||
+                       (worse == Worse::Higher && rel >  tol) ||
+                       (worse == Worse::Either && std::abs(rel) > tol);
+      regressions += bad;
+      std::cout << std::left << std::setw(18) << name << std::setw(24) << metric << std::right
+                << std::setw(14) << b->second << std::setw(14) << c->second
+                << std::setw(9) << std::fixed << std::setprecision(1) << 100.0 * rel << "%"
+                << std::defaultfloat << std::setprecision(6) << (bad ? "  REGRESSION" : "") << "\n";
+    }
+  }
+  std::cout << (regressions ? "FAIL: " : "OK: ") << regressions
+            << " regression(s) at tolerance " << 100.0 * tol << "%" << std::endl;
+  return regressions ? 1 : 0;
+}
+
+void PrintUsage(const char* exe) {
+  std::cerr << "Usage:\n"
+            << "  " << exe << " --all [--events N] [--seed S] [--json FILE] [--verbose]\n"
+            << "  " << exe << " --scenario NAME [--events N] [--seed S] [--json FILE] [--workdir DIR] [--verbose]\n"
+            << "  " << exe << " --compare BASELINE.json CURRENT.json [--tolerance F]\n"
+            << "Scenarios:\n";
+  for (const auto& sc : kScenarios)
+    std::cerr << "  " << std::left << std::setw(18) << sc.name << sc.description << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  std::string scenario, jsonPath, workDir, basePath, curPath;
+  long events = 500, seed = 12345;
+  double tol = 0.10;
+  bool all = false, verbose = false;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool hasValue = i + 1 < argc;
+    if (arg == "--all")                         all = true;
+    else if (arg == "--verbose")                verbose = true;
+    else if (arg == "--scenario" && hasValue)   scenario = argv[++i];
+    else if (arg == "--events" && hasValue)     events = std::atol(argv[++i]);
+    else if (arg == "--seed" && hasValue)       seed = std::atol(argv[++i]);
+    else if (arg == "--json" && hasValue)       jsonPath = argv[++i];
+    else if (arg == "--workdir" && hasValue)    workDir = argv[++i];
+    else if (arg == "--tolerance" && hasValue)  tol = std::atof(argv[++i]);
+    else if (arg == "--compare" && i + 2 < argc) { basePath = argv[++i]; curPath = argv[++i]; }
+    else { PrintUsage(argv[0]); return 2; }
+  }
+
+  if (!basePath.empty()) return Compare(basePath, curPath, tol);
+  if (events <= 0) { PrintUsage(argv[0]); return 2; }
+  if (all) return RunAll(argv[0], events, seed, jsonPath, verbose);
+  if (const Scenario* sc = FindScenario(scenario)) return RunScenario(*sc, events, seed, jsonPath, workDir, verbose);
+  PrintUsage(argv[0]);
+  return 2;
+}
@@ -0,0 +1,302 @@
+// Statistical equivalence gate for deflection_results.csv.
+//
+// Streams a candidate run and the v1.0.0 reference dataset, extracts the
+// err_mm, L1->L3 deflection and L2 pixel-residual distributions, and compares
+// them with two-sample Kolmogorov-Smirnov and Anderson-Darling tests plus
+// per-quantile tolerances (relative, absolute floor, or sampling noise,
+// whichever is widest). Exit code 0 = PASS, 1 = FAIL, 2 = usage/input error.
+//
+//   lekid_validate <candidate.csv> [--reference <repo>/data/deflection_results.csv]
+//                  [--alpha 0.01] [--qtol 0.05] [--qabs 0.01] [--report report.txt]
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Set by CMake to the repository copy so the tool works from the build tree
+#ifndef LEKID_REFERENCE_CSV
+#define LEKID_REFERENCE_CSV "data/deflection_results.csv"
+#endif
+
+namespace {
+
+struct Sample {
+  std::vector<double> err;        // |pred - act| at L2 (mm), rows with an L2 hit
+  std::vector<double> deflection; // lateral L1 -> L3 displacement (mm)
+  std::vector<double> pixelResid; // pixelized L2 prediction vs pixelized L2 hit (mm)
+};
+
+const char* const kMetricNames[] = { "err_mm", "deflection_l1_l3_mm", "pixel_residual_mm" };
+
+std::vector<std::string> SplitCsv(const std::string& line) {
+  std::vector<std::string> out;
+  std::string::size_type start = 0, comma;
+  while ((comma = line.find(',', start)) != std::string::npos) {
+    out.emplace_back(line, start, comma - start);
+    start = comma + 1;
+  }
+  out.emplace_back(line, start);
+  return out;
+}
+
+// Reads only the columns needed; rows are not kept once reduced.
+bool ReadSample(const std::string& path, Sample& s) {
+  std::ifstream in(path);
+  if (!in) { std::cerr << "cannot open " << path << "\n"; return false; }
+
+  std::string line;
+  if (!std::getline(in, line)) { std::cerr << path << " is empty\n"; return false; }
+  if (!line.empty() && line.back() == '\r') line.pop_back();
+  const auto header = SplitCsv(line);
+
+  const char* const kCols[] = { "err_mm", "l1_x_mm", "l1_y_mm", "l3_x_mm", "l3_y_mm",
+                                "pixel_pred_x_mm", "pixel_pred_y_mm", "pixel_act_x_mm", "pixel_act_y_mm" };
+  std::size_t idx[9];
+  std::size_t maxIdx = 0;
+  for (int c = 0; c < 9; ++c) {
+    auto it = std::find(header.begin(), header.end(), kCols[c]);
+    if (it == header.end()) { std::cerr << path << ": missing column " << kCols[c] << "\n"; return false; }
+    idx[c] = static_cast<std::size_t>(it - header.begin());
+    maxIdx = std::max(maxIdx, idx[c]);
+  }
+
+  double v[9];
+  while (std::getline(in, line)) {
+    if (line.empty() || line == "\r") continue;
+    const auto f = SplitCsv(line);
+    if (f.size() <= maxIdx) continue;
+    for (int c = 0; c < 9; ++c) v[c] = std::strtod(f[idx[c]].c_str(), nullptr);
+
+    s.deflection.push_back(std::hypot(v[3] - v[1], v[4] - v[2]));
+    if (v[0] < 0) continue; // no L2 hit recorded for this event
+    s.err.push_back(v[0]);
+    s.pixelResid.push_back(std::hypot(v[5] - v[7], v[6] - v[8]));
+  }
+  return true;
+}
+
+// Two-sample KS statistic on sorted inputs (ties consumed together).
+double KsStatistic(const std::vector<double>& a, const std::vector<double>& b) {
+  const double na = static_cast<double>(a.size()), nb = static_cast<double>(b.size());
+  std::size_t i = 0, j = 0;
+  double d = 0.0;
+  while (i < a.size() && j < b.size()) {
+    const double x = std::min(a[i], b[j]);
+    while (i < a.size() && a[i] == x) ++i;
+    while (j < b.size() && b[j] == x) ++j;
+    d = std::max(d, std::abs(i / na - j / nb));
+  }
+  return d;
+}
+
+// Asymptotic Kolmogorov survival function with the Stephens small-n correction.
+double KsPValue(double d, std::size_t n, std::size_t m) {
+  const double en = std::sqrt(static_cast<double>(n) * m / (n + m));
+  const double lambda = (en + 0.12 + 0.11 / en) * d;
+  if (lambda < 1e-3) return 1.0;
+  double sum = 0.0, sign = 1.0;
+  for (int k = 1; k <= 100; ++k) {
+    const double term = sign * std::exp(-2.0 * k * k * lambda * lambda);
+    sum += term;
+    if (std::abs(term) < 1e-12) break;
+    sign = -sign;
+  }
+  return std::clamp(2.0 * sum, 0.0, 1.0);
+}
+
+// Scholz & Stephens (1987) k-sample Anderson-Darling, midrank version for
+// ties (the pixel residuals are discrete). Returns the standardized T.
+double AndersonDarlingT(const std::vector<double>& a, const std::vector<double>& b) {
+  const std::vector<const std::vector<double>*> samples = { &a, &b };
+  const int k = 2;
+  std::vector<double> pooled(a);
+  pooled.insert(pooled.end(), b.begin(), b.end());
+  std::sort(pooled.begin(), pooled.end());
+  const double N = static_cast<double>(pooled.size());
+
+  // Distinct values z_j and their pooled multiplicities l_j
+  std::vector<double> z, l, B;
+  for (std::size_t p = 0; p < pooled.size();) {
+    std::size_t q = p;
+    while (q < pooled.size() && pooled[q] == pooled[p]) ++q;
+    z.push_back(pooled[p]);
+    l.push_back(static_cast<double>(q - p));
+    B.push_back(p + 0.5 * (q - p)); // #below + half the ties
+    p = q;
+  }
+
+  double A2 = 0.0;
+  for (const auto* s : samples) {
+    const double n = static_cast<double>(s->size());
+    double inner = 0.0;
+    std::size_t lo = 0;
+    for (std::size_t j = 0; j < z.size(); ++j) {
+      while (lo < s->size() && (*s)[lo] < z[j]) ++lo;
+      std::size_t hi = lo;
+      while (hi < s->size() && (*s)[hi] == z[j]) ++hi;
+      const double M = lo + 0.5 * (hi - lo);
+      const double den = B[j] * (N - B[j]) - N * l[j] / 4.0;
+      if (den > 0) inner += l[j] / N * std::pow(N * M - B[j] * n, 2) / den;
+      lo = hi;
+    }
+    A2 += inner / n;
+  }
+  A2 *= (N - 1.0) / N;
+
+  // Variance of A2 under H0
+  double H = 0.0, h = 0.0, g = 0.0, tail = 0.0;
+  for (const auto* s : samples) H += 1.0 / s->size();
+  for (long i = 1; i < static_cast<long>(N); ++i) h += 1.0 / i;
+  for (long j = 2; j < static_cast<long>(N); ++j) { tail += 1.0 / (N - (j - 1)); g += tail / j; }
+  const double a4 = (4*g - 6) * (k - 1) + (10 - 6*g) * H;
+  const double b4 = (2*g - 4) * k*k + 8*h*k + (2*g - 14*h - 4) * H - 8*h + 4*g - 6;
+  const double c4 = (6*h + 2*g - 2) * k*k + (4*h - 4*g + 6) * k + (2*h - 6) * H + 4*h;
+  const double d4 = (2*h + 6) * k*k - 4*h*k;
+  const double var = (a4*N*N*N + b4*N*N + c4*N + d4) / ((N - 1) * (N - 2) * (N - 3));
+  return (A2 - (k - 1)) / std::sqrt(var);
+}
+
+// Interpolated p-value from the Scholz & Stephens critical values (k = 2),
+// clipped to the tabulated range [0.001, 0.25].
+double AndersonDarlingPValue(double T) {
+  const double sig[] = { 0.25, 0.10, 0.05, 0.025, 0.01, 0.005, 0.001 };
+  const double b0[]  = { 0.675, 1.281, 1.645, 1.96, 2.326, 2.573, 3.085 };
+  const double b1[]  = { -0.245, 0.25, 0.678, 1.149, 1.822, 2.364, 3.615 };
+  const double b2[]  = { -0.105, -0.305, -0.362, -0.391, -0.396, -0.345, -0.154 };
+  double crit[7];
+  for (int i = 0; i < 7; ++i) crit[i] = b0[i] + b1[i] + b2[i]; // m = k - 1 = 1
+  if (T <= crit[0]) return sig[0];
+  if (T >= crit[6]) return sig[6];
+  for (int i = 0; i < 6; ++i) {
+    if (T <= crit[i + 1]) {
+      const double f = (T - crit[i]) / (crit[i + 1] - crit[i]);
+      return std::exp(std::log(sig[i]) + f * (std::log(sig[i + 1]) - std::log(sig[i])));
+    }
+  }
+  return sig[6];
+}
+
+double Quantile(const std::vector<double>& sorted, double q) {
+  const double pos = q * (sorted.size() - 1);
+  const std::size_t lo = static_cast<std::size_t>(std::floor(pos));
+  const std::size_t hi = std::min(lo + 1, sorted.size() - 1);
+  return sorted[lo] + (pos - lo) * (sorted[hi] - sorted[lo]);
+}
+
+// Two-sided standard normal critical value z with P(|Z| > z) = alpha.
+double NormalCritical(double alpha) {
+  double lo = 0.0, hi = 10.0;
+  for (int it = 0; it < 100; ++it) {
+    const double mid = 0.5 * (lo + hi);
+    (std::erfc(mid / std::sqrt(2.0)) > alpha ? lo : hi) = mid;
+  }
+  return 0.5 * (lo + hi);
+}
+
+// Half-width, in value units, of the distribution-free band the q-quantile can
+// move by sampling noise alone at level alpha (both sample sizes contribute).
+double QuantileNoise(const std::vector<double>& sorted, double q, std::size_t nCand, double alpha) {
+  const double dp = NormalCritical(alpha) *
+      std::sqrt(q * (1.0 - q) * (1.0 / sorted.size() + 1.0 / nCand));
+  const double lo = Quantile(sorted, std::max(0.0, q - dp));
+  const double hi = Quantile(sorted, std::min(1.0, q + dp));
+  return 0.5 * (hi - lo);
+}
+
+struct Options {
+  std::string candidate;
+  std::string reference = LEKID_REFERENCE_CSV;
+  std::string report;
+  double alpha = 0.01; // significance level for KS and AD
+  double qtol  = 0.05; // relative quantile tolerance
+  double qabs  = 0.01; // absolute quantile tolerance floor (mm)
+};
+
+// Compares one metric; appends its section to 'os' and returns pass/fail.
+bool CompareMetric(const char* name, std::vector<double> ref, std::vector<double> cand,
+                   const Options& opt, std::ostream& os) {
+  static const double kQuantiles[] = { 0.05, 0.25, 0.50, 0.75, 0.95, 0.99 };
+  os << "\n[" << name << "]  n_ref = " << ref.size() << ", n_new = " << cand.size() << "\n";
+  if (ref.size() < 4 || cand.size() < 4) {
+    os << "  too few entries to compare -> FAIL\n";
+    return false;
+  }
+  std::sort(ref.begin(), ref.end());
+  std::sort(cand.begin(), cand.end());
+
+  const double D = KsStatistic(ref, cand);
+  const double pKs = KsPValue(D, ref.size(), cand.size());
+  const double T = AndersonDarlingT(ref, cand);
+  const double pAd = AndersonDarlingPValue(T);
+  const bool ksOk = pKs >= opt.alpha;
+  const bool adOk = pAd >= opt.alpha;
+
+  os << std::fixed << std::setprecision(6)
+     << "  KS: D = " << D << ", p = " << pKs << (ksOk ? "  ok" : "  REJECT") << "\n"
+     << "  AD: T = " << T << ", p " << (pAd <= 0.001 ? "<= " : pAd >= 0.25 ? ">= " : "~ ")
+     << pAd << (adOk ? "  ok" : "  REJECT") << "\n"
+     << "  quantile        ref          new          |diff|       tol\n";
+
+  bool qOk = true;
+  for (double q : kQuantiles) {
+    const double qr = Quantile(ref, q), qc = Quantile(cand, q);
+    const double tol = std::max({ opt.qtol * std::abs(qr), opt.qabs,
+                                  QuantileNoise(ref, q, cand.size(), opt.alpha) });
+    const bool ok = std::abs(qc - qr) <= tol;
+    qOk = qOk && ok;
+    os << "  q" << std::setw(5) << std::left << std::setprecision(2) << q << std::right
+       << std::setprecision(6) << std::setw(13) << qr << std::setw(13) << qc
+       << std::setw(13) << std::abs(qc - qr) << std::setw(13) << tol << (ok ? "" : "  OUT") << "\n";
+  }
+
+  const bool pass = ksOk && adOk && qOk;
+  os << "  -> " << (pass ? "PASS" : "FAIL") << "\n";
+  return pass;
+}
+
+void PrintUsage(const char* exe) {
+  std::cerr << "Usage: " << exe << " <candidate.csv> [--reference FILE] [--alpha A]"
+            << " [--qtol REL] [--qabs MM] [--report FILE]\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool hasValue = i + 1 < argc;
+    if (arg == "--reference" && hasValue)   opt.reference = argv[++i];
+    else if (arg == "--report" && hasValue) opt.report = argv[++i];
+    else if (arg == "--alpha" && hasValue)  opt.alpha = std::atof(argv[++i]);
+    else if (arg == "--qtol" && hasValue)   opt.qtol = std::atof(argv[++i]);
+    else if (arg == "--qabs" && hasValue)   opt.qabs = std::atof(argv[++i]);
+    else if (arg.rfind("--", 0) == 0 || !opt.candidate.empty()) { PrintUsage(argv[0]); return 2; }
+    else opt.candidate = arg;
+  }
+  if (opt.candidate.empty()) { PrintUsage(argv[0]); return 2; }
+
+  Sample ref, cand;
+  if (!ReadSample(opt.reference, ref) || !ReadSample(opt.candidate, cand)) return 2;
+
+  std::ostringstream os;
+  os << "Statistical equivalence: " << opt.candidate << " vs " << opt.reference << "\n"
+     << "alpha = " << opt.alpha << ", quantile tolerance = " << 100.0 * opt.qtol
+     << "% (floor " << opt.qabs << " mm)\n";
+
+  bool pass = true;
+  pass &= CompareMetric(kMetricNames[0], ref.err, cand.err, opt, os);
+  pass &= CompareMetric(kMetricNames[1], ref.deflection, cand.deflection, opt, os);
+  pass &= CompareMetric(kMetricNames[2], ref.pixelResid, cand.pixelResid, opt, os);
+  os << "\nVERDICT: " << (pass ? "PASS" : "FAIL") << "\n";
+
+  std::cout << os.str();
+  if (!opt.report.empty()) std::ofstream(opt.report, std::ios::trunc) << os.str();
+  return pass ? 0 : 1;
+}